@@ -0,0 +1,231 @@
+# Gera inc/font_matrix.h a partir de inc/font.h, reduzindo cada glifo 8x8 do OLED para 5 linhas, a altura da matriz de
+# LEDs.
+#
+# Uso: cmake -DFONT=<font.h> -DOUTPUT=<font_matrix.h> -P font_matrix.cmake
+#
+# Os glifos de font.h são colunas de 8 bits (bit 0 = linha de cima). Só a altura é reduzida: o letreiro rola um fluxo
+# de colunas, então cada glifo mantém as suas colunas acesas (as vazias das bordas são removidas) e a sua largura.
+#
+# As linhas vão da primeira à última acesa do glifo (até 8, com a cauda de Q, g, j, p, q e y) e são descartadas uma a
+# uma até restarem 5. Primeiro sai uma cópia de uma linha repetida, da sequência mais longa, o que não perde nenhum
+# detalhe (o meio das hastes, a barra dupla do T) e mantém o pingo do i e do j separado da haste. Sem linhas repetidas,
+# saem alternadamente a penúltima e a segunda linha, deixando o topo, o meio e a base.
+
+if(NOT FONT OR NOT OUTPUT)
+  message(FATAL_ERROR "Informe -DFONT=<font.h> e -DOUTPUT=<font_matrix.h>")
+endif()
+
+set(HEIGHT 5)
+set(SPACE_WIDTH 3) # Largura do glifo vazio, usado como espaço
+set(LABELS "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz")
+
+file(READ ${FONT} source)
+string(REGEX REPLACE "//[^\n]*" "" source "${source}")
+string(REGEX MATCHALL "0x[0-9a-fA-F]+" bytes "${source}")
+list(LENGTH bytes byte_count)
+math(EXPR glyph_count "${byte_count} / 8")
+math(EXPR last_glyph "${glyph_count} - 1")
+
+set(max_width 0)
+set(glyph_widths "")
+set(glyph_columns "")
+foreach(glyph RANGE ${last_glyph})
+  # Colunas acesas do glifo
+  set(columns "")
+  set(first -1)
+  set(last -1)
+  foreach(column RANGE 7)
+    math(EXPR index "${glyph} * 8 + ${column}")
+    list(GET bytes ${index} byte)
+    math(EXPR byte "${byte}")
+    list(APPEND columns ${byte})
+    if(NOT byte EQUAL 0)
+      if(first LESS 0)
+        set(first ${column})
+      endif()
+      set(last ${column})
+    endif()
+  endforeach()
+
+  if(first LESS 0)
+    list(APPEND glyph_widths ${SPACE_WIDTH})
+    list(APPEND glyph_columns 0)
+    continue()
+  endif()
+  math(EXPR width "${last} - ${first} + 1")
+  list(SUBLIST columns ${first} ${width} columns)
+  list(APPEND glyph_widths ${width})
+  if(width GREATER max_width)
+    set(max_width ${width})
+  endif()
+
+  # Linhas do glifo, com o padrão de cada uma (um caractere por coluna) para comparar linhas vizinhas
+  set(used 0)
+  foreach(byte IN LISTS columns)
+    math(EXPR used "${used} | ${byte}")
+  endforeach()
+  set(rows "")
+  set(patterns "")
+  set(started FALSE)
+  foreach(row RANGE 7)
+    math(EXPR lit "(${used} >> ${row}) & 1")
+    if(lit)
+      set(started TRUE)
+    endif()
+    if(started)
+      set(pattern "")
+      foreach(byte IN LISTS columns)
+        math(EXPR bit "(${byte} >> ${row}) & 1")
+        string(APPEND pattern ${bit})
+      endforeach()
+      list(APPEND rows ${row})
+      list(APPEND patterns ${pattern})
+    endif()
+  endforeach()
+  # Remove as linhas vazias depois da última acesa
+  list(LENGTH rows count)
+  math(EXPR bottom "${count} - 1")
+  list(GET patterns ${bottom} pattern)
+  while(NOT pattern MATCHES "1")
+    list(REMOVE_AT rows ${bottom})
+    list(REMOVE_AT patterns ${bottom})
+    math(EXPR bottom "${bottom} - 1")
+    list(GET patterns ${bottom} pattern)
+  endwhile()
+
+  # Descarta linhas até restarem HEIGHT
+  set(fallbacks 0)
+  list(LENGTH rows count)
+  while(count GREATER HEIGHT)
+    # Par de linhas vizinhas iguais na sequência mais longa; no empate, o mais distante do meio
+    math(EXPR last_pair "${count} - 2")
+    set(best -1)
+    set(best_run 0)
+    set(best_distance -1)
+    foreach(k RANGE ${last_pair})
+      math(EXPR next "${k} + 1")
+      list(GET patterns ${k} a)
+      list(GET patterns ${next} b)
+      if(NOT a STREQUAL b)
+        continue()
+      endif()
+      set(start ${k})
+      while(start GREATER 0)
+        math(EXPR previous "${start} - 1")
+        list(GET patterns ${previous} p)
+        if(NOT p STREQUAL a)
+          break()
+        endif()
+        set(start ${previous})
+      endwhile()
+      set(end ${next})
+      while(end LESS bottom)
+        math(EXPR following "${end} + 1")
+        list(GET patterns ${following} p)
+        if(NOT p STREQUAL a)
+          break()
+        endif()
+        set(end ${following})
+      endwhile()
+      math(EXPR run "${end} - ${start} + 1")
+      math(EXPR distance "2 * ${k} + 1 - ${bottom}") # Dobro da distância do centro do par ao meio
+      if(distance LESS 0)
+        math(EXPR distance "-${distance}")
+      endif()
+      if(run GREATER best_run OR (run EQUAL best_run AND distance GREATER best_distance))
+        set(best ${k})
+        set(best_run ${run})
+        set(best_distance ${distance})
+      endif()
+    endforeach()
+
+    if(best GREATER_EQUAL 0)
+      # Nunca descarta a primeira linha
+      if(best EQUAL 0)
+        set(drop 1)
+      else()
+        set(drop ${best})
+      endif()
+    else()
+      math(EXPR side "${fallbacks} % 2")
+      if(side EQUAL 0)
+        math(EXPR drop "${count} - 2")
+      else()
+        set(drop 1)
+      endif()
+      math(EXPR fallbacks "${fallbacks} + 1")
+    endif()
+
+    list(REMOVE_AT rows ${drop})
+    list(REMOVE_AT patterns ${drop})
+    math(EXPR count "${count} - 1")
+    math(EXPR bottom "${count} - 1")
+  endwhile()
+
+  # Amostra as linhas: o bit k da coluna é a linha rows[k] do glifo
+  set(output "")
+  foreach(byte IN LISTS columns)
+    set(value 0)
+    set(bit 0)
+    foreach(row IN LISTS rows)
+      math(EXPR value "${value} | (((${byte} >> ${row}) & 1) << ${bit})")
+      math(EXPR bit "${bit} + 1")
+    endforeach()
+    list(APPEND output ${value})
+  endforeach()
+  string(REPLACE ";" "," output "${output}")
+  list(APPEND glyph_columns "${output}")
+endforeach()
+
+# Tabelas: colunas alinhadas à esquerda e completadas com zeros até a maior largura
+set(table "")
+set(widths "")
+foreach(glyph RANGE ${last_glyph})
+  list(GET glyph_widths ${glyph} width)
+  list(GET glyph_columns ${glyph} output)
+  string(REPLACE "," ";" output "${output}")
+  set(columns "")
+  foreach(column RANGE 1 ${max_width})
+    list(LENGTH output used)
+    set(value 0)
+    if(column LESS_EQUAL used)
+      math(EXPR index "${column} - 1")
+      list(GET output ${index} value)
+    endif()
+    math(EXPR value "${value}" OUTPUT_FORMAT HEXADECIMAL)
+    string(REGEX REPLACE "^0x(.)$" "0x0\\1" value "${value}")
+    string(APPEND columns "${value},")
+  endforeach()
+
+  set(label "Nothing")
+  string(LENGTH "${LABELS}" label_count)
+  if(glyph GREATER 0 AND glyph LESS_EQUAL label_count)
+    math(EXPR label_index "${glyph} - 1")
+    string(SUBSTRING "${LABELS}" ${label_index} 1 label)
+  endif()
+  string(APPEND table "    ${columns}  // ${label}\n")
+  string(APPEND widths "    ${width},  // ${label}\n")
+endforeach()
+
+file(WRITE ${OUTPUT}
+"// ------------------------------------------------------------- //
+// This file is autogenerated by font_matrix.cmake; do not edit! //
+// ------------------------------------------------------------- //
+
+#pragma once
+
+#include <stdint.h>
+
+// Glifos de font.h reduzidos para 5 linhas, na mesma ordem (0 = vazio, 1 a 10 = dígitos, 11 a 36 = A-Z, ...)
+// Cada glifo ocupa FONT_MATRIX_MAX_WIDTH colunas, das quais só as font_matrix_width[glifo] primeiras são usadas;
+// o bit 0 de cada coluna é a linha de cima da matriz
+#define FONT_MATRIX_GLYPHS ${glyph_count}
+#define FONT_MATRIX_HEIGHT ${HEIGHT}
+#define FONT_MATRIX_MAX_WIDTH ${max_width}
+
+static const uint8_t font_matrix_width[FONT_MATRIX_GLYPHS] = {
+${widths}};
+
+static const uint8_t font_matrix[FONT_MATRIX_GLYPHS * FONT_MATRIX_MAX_WIDTH] = {
+${table}};
+")
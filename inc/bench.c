@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include "bench.h"
+#include "hardware/clocks.h"
+
+/**
+ * @brief Run SysTick as a free-running 24-bit counter on the processor clock.
+ */
+void bench_init(void) {
+  systick_hw->csr = 0;
+  systick_hw->rvr = BENCH_SYSTICK_MASK;
+  systick_hw->cvr = 0;
+  systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+/**
+ * @brief Clear a histogram.
+ * 
+ * @param hist Pointer to the histogram.
+ * @param name Workload name printed in the report (no commas).
+ */
+void bench_hist_reset(bench_hist_t *hist, const char *name) {
+  hist->name = name;
+  hist->samples = 0;
+  hist->min_cycles = UINT32_MAX;
+  hist->max_cycles = 0;
+  hist->sum_cycles = 0;
+  hist->sum_us = 0;
+  for (uint8_t i = 0; i < BENCH_BUCKETS; ++i)
+    hist->buckets[i] = 0;
+}
+
+/**
+ * @brief Add a sample to a histogram.
+ * 
+ * Bucket k counts samples in [2^k, 2^(k+1)) cycles; bucket 0 also holds 0.
+ * 
+ * @param hist Pointer to the histogram.
+ * @param cycles Duration in processor cycles.
+ * @param us Duration in microseconds.
+ */
+void bench_hist_add(bench_hist_t *hist, uint32_t cycles, uint32_t us) {
+  uint8_t bucket = cycles ? 31 - __builtin_clz(cycles) : 0;
+
+  ++hist->buckets[bucket];
+  ++hist->samples;
+  hist->sum_cycles += cycles;
+  hist->sum_us += us;
+  if (cycles < hist->min_cycles)
+    hist->min_cycles = cycles;
+  if (cycles > hist->max_cycles)
+    hist->max_cycles = cycles;
+}
+
+/**
+ * @brief Close a measurement started with bench_start() and record it.
+ * 
+ * SysTick wraps every 2^24 cycles, so longer workloads fall back to the
+ * microsecond timer scaled to the processor clock.
+ * 
+ * @param hist Pointer to the histogram.
+ * @param start Stamp returned by bench_start().
+ */
+void bench_stop(bench_hist_t *hist, bench_stamp_t start) {
+  uint32_t cycles = bench_elapsed(start.cycles, bench_cycles());
+  uint32_t us = time_us_32() - start.us;
+  uint32_t cycles_per_us = clock_get_hz(clk_sys) / 1000000;
+
+  // Margem de 1 us de cada lado para a leitura dos dois contadores
+  if ((uint64_t)(us + 2) * cycles_per_us >= BENCH_SYSTICK_MASK)
+    cycles = us * cycles_per_us;
+  bench_hist_add(hist, cycles, us);
+}
+
+/**
+ * @brief Print the report header with the clock the cycle counts refer to.
+ */
+void bench_report_begin(void) {
+  printf("BENCH_BEGIN,clk_sys_hz=%lu\n", (unsigned long)clock_get_hz(clk_sys));
+  printf("# BENCH,name,samples,min_cycles,max_cycles,mean_cycles,mean_us\n");
+  printf("# HIST,name,lo_cycles,hi_cycles,count\n");
+}
+
+/**
+ * @brief Print a histogram in the CSV format announced by bench_report_begin().
+ * 
+ * @param hist Pointer to the histogram.
+ */
+void bench_hist_print(const bench_hist_t *hist) {
+  if (!hist->samples) {
+    printf("BENCH,%s,0,0,0,0,0\n", hist->name);
+    return;
+  }
+
+  printf("BENCH,%s,%lu,%lu,%lu,%lu,%lu\n",
+    hist->name,
+    (unsigned long)hist->samples,
+    (unsigned long)hist->min_cycles,
+    (unsigned long)hist->max_cycles,
+    (unsigned long)(hist->sum_cycles / hist->samples),
+    (unsigned long)(hist->sum_us / hist->samples)
+  );
+  for (uint8_t i = 0; i < BENCH_BUCKETS; ++i) {
+    if (!hist->buckets[i])
+      continue;
+    uint32_t lo = i ? (1u << i) : 0;
+    uint32_t hi = (i == 31) ? UINT32_MAX : (1u << (i + 1)) - 1;
+    printf("HIST,%s,%lu,%lu,%lu\n", hist->name, (unsigned long)lo, (unsigned long)hi, (unsigned long)hist->buckets[i]);
+  }
+}
+
+/**
+ * @brief Print the report trailer.
+ */
+void bench_report_end(void) {
+  printf("BENCH_END\n");
+}
@@ -0,0 +1,56 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+
+#define BENCH_BUCKETS 32
+#define BENCH_SYSTICK_MASK M0PLUS_SYST_RVR_BITS
+
+typedef struct {
+  uint32_t cycles, us;
+} bench_stamp_t;
+
+typedef struct {
+  const char *name;
+  uint32_t samples;
+  uint32_t min_cycles, max_cycles;
+  uint64_t sum_cycles, sum_us;
+  uint32_t buckets[BENCH_BUCKETS];
+} bench_hist_t;
+
+void bench_init(void);
+void bench_hist_reset(bench_hist_t *hist, const char *name);
+void bench_hist_add(bench_hist_t *hist, uint32_t cycles, uint32_t us);
+void bench_stop(bench_hist_t *hist, bench_stamp_t start);
+void bench_report_begin(void);
+void bench_hist_print(const bench_hist_t *hist);
+void bench_report_end(void);
+
+/**
+ * @brief Read the SysTick counter (counts down at the processor clock).
+ */
+static inline uint32_t bench_cycles(void) {
+  return systick_hw->cvr;
+}
+
+/**
+ * @brief Cycles elapsed between two SysTick readings.
+ * 
+ * Only valid for intervals shorter than one 24-bit wrap.
+ */
+static inline uint32_t bench_elapsed(uint32_t start, uint32_t end) {
+  return (start - end) & BENCH_SYSTICK_MASK;
+}
+
+/**
+ * @brief Take a cycle and microsecond timestamp at the start of a measurement.
+ */
+static inline bench_stamp_t bench_start(void) {
+  bench_stamp_t stamp;
+  stamp.us = time_us_32();
+  stamp.cycles = bench_cycles();
+  return stamp;
+}
+
+#endif
@@ -0,0 +1,146 @@
+// ------------------------------------------------------------- //
+// This file is autogenerated by font_matrix.cmake; do not edit! //
+// ------------------------------------------------------------- //
+
+#pragma once
+
+#include <stdint.h>
+
+// Glifos de font.h reduzidos para 5 linhas, na mesma ordem (0 = vazio, 1 a 10 = dígitos, 11 a 36 = A-Z, ...)
+// Cada glifo ocupa FONT_MATRIX_MAX_WIDTH colunas, das quais só as font_matrix_width[glifo] primeiras são usadas;
+// o bit 0 de cada coluna é a linha de cima da matriz
+#define FONT_MATRIX_GLYPHS 63
+#define FONT_MATRIX_HEIGHT 5
+#define FONT_MATRIX_MAX_WIDTH 7
+
+static const uint8_t font_matrix_width[FONT_MATRIX_GLYPHS] = {
+    3,  // Nothing
+    7,  // 0
+    6,  // 1
+    7,  // 2
+    7,  // 3
+    7,  // 4
+    7,  // 5
+    7,  // 6
+    7,  // 7
+    7,  // 8
+    7,  // 9
+    7,  // A
+    7,  // B
+    7,  // C
+    7,  // D
+    7,  // E
+    7,  // F
+    7,  // G
+    7,  // H
+    4,  // I
+    7,  // J
+    7,  // K
+    7,  // L
+    7,  // M
+    7,  // N
+    7,  // O
+    7,  // P
+    7,  // Q
+    7,  // R
+    7,  // S
+    6,  // T
+    7,  // U
+    7,  // V
+    7,  // W
+    7,  // X
+    6,  // Y
+    7,  // Z
+    7,  // a
+    7,  // b
+    7,  // c
+    7,  // d
+    7,  // e
+    7,  // f
+    7,  // g
+    7,  // h
+    4,  // i
+    6,  // j
+    7,  // k
+    4,  // l
+    7,  // m
+    7,  // n
+    7,  // o
+    7,  // p
+    7,  // q
+    7,  // r
+    7,  // s
+    7,  // t
+    7,  // u
+    7,  // v
+    7,  // w
+    7,  // x
+    7,  // y
+    6,  // z
+};
+
+static const uint8_t font_matrix[FONT_MATRIX_GLYPHS * FONT_MATRIX_MAX_WIDTH] = {
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,  // Nothing
+    0x0e,0x1f,0x19,0x15,0x13,0x1f,0x0e,  // 0
+    0x10,0x12,0x1f,0x1f,0x10,0x10,0x00,  // 1
+    0x10,0x11,0x19,0x1d,0x15,0x17,0x12,  // 2
+    0x00,0x11,0x15,0x15,0x15,0x1f,0x0a,  // 3
+    0x0c,0x0e,0x0a,0x19,0x1f,0x1f,0x18,  // 4
+    0x07,0x17,0x15,0x15,0x15,0x1d,0x09,  // 5
+    0x0c,0x1e,0x1b,0x19,0x19,0x18,0x00,  // 6
+    0x03,0x03,0x11,0x19,0x0d,0x07,0x03,  // 7
+    0x0a,0x1f,0x15,0x15,0x15,0x1f,0x0a,  // 8
+    0x02,0x17,0x15,0x15,0x15,0x0f,0x0e,  // 9
+    0x1c,0x1e,0x0b,0x09,0x0b,0x1e,0x1c,  // A
+    0x11,0x1f,0x1f,0x15,0x15,0x1f,0x0a,  // B
+    0x04,0x0e,0x1b,0x11,0x11,0x1b,0x0a,  // C
+    0x11,0x1f,0x1f,0x11,0x1b,0x0e,0x04,  // D
+    0x11,0x1f,0x1f,0x15,0x1f,0x11,0x11,  // E
+    0x11,0x1f,0x1f,0x15,0x0f,0x01,0x01,  // F
+    0x0c,0x0e,0x13,0x11,0x19,0x0b,0x1a,  // G
+    0x1f,0x1f,0x04,0x04,0x04,0x1f,0x1f,  // H
+    0x11,0x1f,0x1f,0x11,0x00,0x00,0x00,  // I
+    0x0c,0x1c,0x10,0x11,0x1f,0x0f,0x01,  // J
+    0x11,0x1f,0x1f,0x04,0x0e,0x1b,0x11,  // K
+    0x11,0x1f,0x1f,0x11,0x10,0x18,0x1c,  // L
+    0x1f,0x1f,0x06,0x0c,0x06,0x1f,0x1f,  // M
+    0x1f,0x1f,0x06,0x0c,0x08,0x1f,0x1f,  // N
+    0x0e,0x1f,0x11,0x11,0x11,0x1f,0x0e,  // O
+    0x11,0x1f,0x1f,0x15,0x05,0x07,0x02,  // P
+    0x06,0x0f,0x09,0x09,0x1d,0x1f,0x16,  // Q
+    0x11,0x1f,0x1f,0x05,0x0d,0x1f,0x12,  // R
+    0x00,0x13,0x17,0x15,0x1d,0x19,0x00,  // S
+    0x03,0x11,0x1f,0x1f,0x11,0x03,0x00,  // T
+    0x0f,0x1f,0x10,0x10,0x10,0x1f,0x0f,  // U
+    0x07,0x0f,0x18,0x10,0x18,0x0f,0x07,  // V
+    0x0f,0x1f,0x18,0x0e,0x18,0x1f,0x0f,  // W
+    0x11,0x1b,0x0e,0x04,0x0e,0x1b,0x11,  // X
+    0x01,0x13,0x1e,0x1e,0x13,0x01,0x00,  // Y
+    0x13,0x11,0x19,0x1d,0x17,0x13,0x19,  // Z
+    0x08,0x1d,0x15,0x15,0x0f,0x1e,0x10,  // a
+    0x11,0x1f,0x0f,0x14,0x14,0x1c,0x08,  // b
+    0x0e,0x1f,0x11,0x11,0x11,0x1b,0x0a,  // c
+    0x08,0x1c,0x14,0x15,0x0f,0x1f,0x10,  // d
+    0x0e,0x1f,0x15,0x15,0x15,0x17,0x06,  // e
+    0x18,0x1e,0x1f,0x19,0x09,0x03,0x02,  // f
+    0x12,0x17,0x15,0x15,0x1e,0x0f,0x01,  // g
+    0x11,0x1f,0x1f,0x08,0x04,0x1c,0x18,  // h
+    0x14,0x1d,0x1d,0x10,0x00,0x00,0x00,  // i
+    0x08,0x18,0x10,0x10,0x1d,0x0d,0x00,  // j
+    0x11,0x1f,0x1f,0x08,0x0c,0x16,0x12,  // k
+    0x11,0x1f,0x1f,0x10,0x00,0x00,0x00,  // l
+    0x1f,0x1f,0x03,0x1e,0x03,0x1f,0x1e,  // m
+    0x01,0x1f,0x1e,0x01,0x01,0x1f,0x1e,  // n
+    0x0e,0x1f,0x11,0x11,0x11,0x1f,0x0e,  // o
+    0x11,0x1f,0x1e,0x15,0x05,0x07,0x02,  // p
+    0x02,0x07,0x05,0x15,0x1e,0x1f,0x11,  // q
+    0x11,0x1f,0x1e,0x13,0x01,0x03,0x02,  // r
+    0x12,0x17,0x15,0x15,0x15,0x1d,0x09,  // s
+    0x02,0x02,0x0f,0x1f,0x12,0x1a,0x08,  // t
+    0x0f,0x1f,0x10,0x10,0x0f,0x1f,0x10,  // u
+    0x07,0x0f,0x18,0x10,0x18,0x0f,0x07,  // v
+    0x0f,0x1f,0x18,0x0e,0x18,0x1f,0x0f,  // w
+    0x11,0x1b,0x0e,0x04,0x0e,0x1b,0x11,  // x
+    0x13,0x17,0x14,0x14,0x14,0x1f,0x0f,  // y
+    0x13,0x19,0x1d,0x17,0x13,0x19,0x00,  // z
+};
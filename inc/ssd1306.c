@@ -1,26 +1,318 @@
 #include "ssd1306.h"
 #include "font.h"
+#include "hardware/dma.h"
 
 /**
- * @brief Initialize the SSD1306 display.
+ * @brief Fill the fields shared by every transport.
  * 
  * @param ssd Pointer to the SSD1306 structure.
  * @param width Width of the display.
  * @param height Height of the display.
  * @param external_vcc Use external VCC.
- * @param address I2C address of the display.
- * @param i2c Pointer to the I2C instance.
  */
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+static void ssd1306_init_common(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc) {
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
-  ssd->address = address;
-  ssd->i2c_port = i2c;
+  ssd->external_vcc = external_vcc;
+  ssd->i2c_port = NULL;
+  ssd->spi_port = NULL;
+  ssd->dma_chan = -1;
+  ssd->dma_words = NULL;
+  ssd->in_flight = false;
+  ssd->in_flight_frame = false;
+  ssd->flush_start_us = 0;
+  ssd->flush_last_us = 0;
+  ssd->flush_count = 0;
+  ssd->flush_total_us = 0;
+  ssd->flush_errors = 0;
   ssd->bufsize = ssd->pages * ssd->width + 1;
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
-  ssd->port_buffer[0] = 0x80;
+}
+
+/**
+ * @brief Initialize the SSD1306 display.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param width Width of the display.
+ * @param height Height of the display.
+ * @param external_vcc Use external VCC.
+ * @param address I2C address of the display.
+ * @param i2c Pointer to the I2C instance.
+ */
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  ssd1306_init_common(ssd, width, height, external_vcc);
+  ssd->transport = SSD1306_TRANSPORT_I2C;
+  ssd->address = address;
+  ssd->i2c_port = i2c;
+}
+
+/**
+ * @brief Initialize the SSD1306 display on a 4-wire SPI bus.
+ * 
+ * The SPI instance must already be set up with spi_init() (mode 0, up to
+ * 10 MHz) and its SCK/MOSI pins routed to GPIO_FUNC_SPI.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param width Width of the display.
+ * @param height Height of the display.
+ * @param external_vcc Use external VCC.
+ * @param spi Pointer to the SPI instance.
+ * @param cs_pin GPIO driving the chip select line (active low).
+ * @param dc_pin GPIO driving the data/command line (low for commands).
+ */
+void ssd1306_init_spi(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, spi_inst_t *spi, uint cs_pin, uint dc_pin) {
+  ssd1306_init_common(ssd, width, height, external_vcc);
+  ssd->transport = SSD1306_TRANSPORT_SPI;
+  ssd->address = 0;
+  ssd->spi_port = spi;
+  ssd->cs_pin = cs_pin;
+  ssd->dc_pin = dc_pin;
+
+  gpio_init(cs_pin);
+  gpio_set_dir(cs_pin, GPIO_OUT);
+  gpio_put(cs_pin, 1);
+  gpio_init(dc_pin);
+  gpio_set_dir(dc_pin, GPIO_OUT);
+  gpio_put(dc_pin, 0);
+}
+
+/**
+ * @brief Claim a DMA channel so that frame flushes run in the background.
+ * 
+ * On I2C the frame is streamed into the IC_DATA_CMD register, so a second
+ * buffer of 16-bit data/command words is allocated. The RAM buffer is
+ * copied into it when the flush starts and may be redrawn right away.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ */
+void ssd1306_enable_dma(ssd1306_t *ssd) {
+  if (ssd->dma_chan >= 0)
+    return;
+
+  ssd->dma_chan = dma_claim_unused_channel(true);
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_chan);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+
+  if (ssd->transport == SSD1306_TRANSPORT_SPI) {
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(ssd->spi_port, true));
+    dma_channel_configure(
+      ssd->dma_chan,
+      &c,
+      &spi_get_hw(ssd->spi_port)->dr,
+      ssd->ram_buffer + 1,
+      ssd->bufsize - 1,
+      false
+    );
+    return;
+  }
+
+  ssd->dma_words = calloc(ssd->bufsize, sizeof(uint16_t));
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(
+    ssd->dma_chan,
+    &c,
+    &i2c_get_hw(ssd->i2c_port)->data_cmd,
+    ssd->dma_words,
+    ssd->bufsize,
+    false
+  );
+}
+
+/**
+ * @brief Check whether two displays share the same bus.
+ * 
+ * @param a Pointer to the first SSD1306 structure.
+ * @param b Pointer to the second SSD1306 structure.
+ * @return true if a flush on one of them must wait for the other.
+ */
+bool ssd1306_same_bus(const ssd1306_t *a, const ssd1306_t *b) {
+  if (a->transport != b->transport)
+    return false;
+  if (a->transport == SSD1306_TRANSPORT_SPI)
+    return a->spi_port == b->spi_port;
+  return a->i2c_port == b->i2c_port;
+}
+
+/**
+ * @brief Offset of a column's page in the RAM buffer.
+ * 
+ * The display runs in vertical addressing mode, so each column is a run of
+ * pages; the first byte of the buffer is the I2C control byte.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param x Column.
+ * @param page Page (row of 8 pixels) within the column.
+ * @return Index into ram_buffer.
+ */
+static inline size_t ssd1306_offset(const ssd1306_t *ssd, uint8_t x, uint8_t page) {
+  return (size_t)x * ssd->pages + page + 1;
+}
+
+/**
+ * @brief Fill the configuration command sequence.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param cmds Output buffer, at least SSD1306_CMD_BUFSIZE - 1 bytes.
+ * @return Number of command bytes written.
+ */
+static size_t ssd1306_config_commands(ssd1306_t *ssd, uint8_t *cmds) {
+  size_t n = 0;
+  cmds[n++] = SET_DISP | 0x00;
+  cmds[n++] = SET_MEM_ADDR;
+  cmds[n++] = 0x01;
+  cmds[n++] = SET_DISP_START_LINE | 0x00;
+  cmds[n++] = SET_SEG_REMAP | 0x01;
+  cmds[n++] = SET_MUX_RATIO;
+  cmds[n++] = ssd->height - 1;
+  cmds[n++] = SET_COM_OUT_DIR | 0x08;
+  cmds[n++] = SET_DISP_OFFSET;
+  cmds[n++] = 0x00;
+  cmds[n++] = SET_COM_PIN_CFG;
+  cmds[n++] = 0x12;
+  cmds[n++] = SET_DISP_CLK_DIV;
+  cmds[n++] = 0x80;
+  cmds[n++] = SET_PRECHARGE;
+  cmds[n++] = 0xF1;
+  cmds[n++] = SET_VCOM_DESEL;
+  cmds[n++] = 0x30;
+  cmds[n++] = SET_CONTRAST;
+  cmds[n++] = 0xFF;
+  cmds[n++] = SET_ENTIRE_ON;
+  cmds[n++] = SET_NORM_INV;
+  cmds[n++] = SET_CHARGE_PUMP;
+  cmds[n++] = 0x14;
+  cmds[n++] = SET_DISP | 0x01;
+  return n;
+}
+
+/**
+ * @brief Point the I2C controller at the display before a DMA transfer.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ */
+static void ssd1306_i2c_target(ssd1306_t *ssd) {
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+}
+
+/**
+ * @brief Record the timing of a finished flush.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ */
+static void ssd1306_flush_done(ssd1306_t *ssd) {
+  ssd->flush_last_us = time_us_32() - ssd->flush_start_us;
+  ssd->flush_total_us += ssd->flush_last_us;
+  ++ssd->flush_count;
+}
+
+/**
+ * @brief Send a byte stream over the display's transport.
+ * 
+ * On I2C the stream goes out as one transaction led by the control byte
+ * (0x00 for commands, 0x40 for data); on SPI the D/C pin selects the same.
+ * The byte just before the payload is borrowed for the control byte by a
+ * blocking I2C write, so it must belong to the same buffer. With async set
+ * and DMA enabled the transfer runs in the background, finished by
+ * ssd1306_busy(); otherwise it blocks. A data stream counts as a flush.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param data true for display RAM data, false for commands.
+ * @param payload Bytes to send.
+ * @param len Number of bytes to send.
+ * @param async Use DMA if the display has a channel.
+ */
+static void ssd1306_write(ssd1306_t *ssd, bool data, uint8_t *payload, size_t len, bool async) {
+  ssd1306_wait(ssd);
+  bool dma = async && ssd->dma_chan >= 0;
+
+  if (ssd->transport == SSD1306_TRANSPORT_SPI) {
+    gpio_put(ssd->dc_pin, data);
+    gpio_put(ssd->cs_pin, 0);
+    if (dma) {
+      ssd->in_flight = true;
+      ssd->in_flight_frame = data;
+      dma_channel_transfer_from_buffer_now(ssd->dma_chan, payload, len);
+      return;
+    }
+    spi_write_blocking(ssd->spi_port, payload, len);
+    gpio_put(ssd->cs_pin, 1);
+  } else {
+    uint8_t control = data ? 0x40 : 0x00;
+    if (dma) {
+      ssd1306_i2c_target(ssd);
+      ssd->dma_words[0] = control;
+      for (size_t i = 0; i < len; ++i)
+        ssd->dma_words[i + 1] = payload[i];
+      ssd->dma_words[len] |= I2C_IC_DATA_CMD_STOP_BITS;
+      ssd->in_flight = true;
+      ssd->in_flight_frame = data;
+      dma_channel_transfer_from_buffer_now(ssd->dma_chan, ssd->dma_words, len + 1);
+      return;
+    }
+
+    // Empresta o byte anterior ao trecho para o byte de controle e o restaura em seguida
+    uint8_t saved = payload[-1];
+    payload[-1] = control;
+    if (i2c_write_blocking(ssd->i2c_port, ssd->address, payload - 1, len + 1, false) < 0 && data)
+      ++ssd->flush_errors;
+    payload[-1] = saved;
+  }
+
+  if (data)
+    ssd1306_flush_done(ssd);
+}
+
+/**
+ * @brief Send a command stream to the SSD1306 display.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param cmds Commands to send, preceded by a spare byte.
+ * @param len Number of commands.
+ * @param async Use DMA if the display has a channel.
+ */
+static void ssd1306_write_commands(ssd1306_t *ssd, uint8_t *cmds, size_t len, bool async) {
+  ssd1306_write(ssd, false, cmds, len, async);
+}
+
+/**
+ * @brief Send a stream of display RAM data to the SSD1306 display.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param bytes Data to send, preceded by a spare byte.
+ * @param len Number of bytes.
+ * @param async Use DMA if the display has a channel.
+ */
+static void ssd1306_write_data(ssd1306_t *ssd, uint8_t *bytes, size_t len, bool async) {
+  ssd1306_write(ssd, true, bytes, len, async);
+}
+
+/**
+ * @brief Set the column and page window of the next data stream.
+ * 
+ * The six address bytes go out as one blocking command stream.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param x0 First column.
+ * @param x1 Last column (inclusive).
+ */
+static void ssd1306_set_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1) {
+  ssd1306_wait(ssd); // O DMA do SPI lê cmd_buffer diretamente
+  uint8_t *cmds = ssd->cmd_buffer + 1;
+  cmds[0] = SET_COL_ADDR;
+  cmds[1] = x0;
+  cmds[2] = x1;
+  cmds[3] = SET_PAGE_ADDR;
+  cmds[4] = 0;
+  cmds[5] = ssd->pages - 1;
+  ssd1306_write_commands(ssd, cmds, 6, false);
 }
 
 /**
@@ -29,31 +321,23 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
  * @param ssd Pointer to the SSD1306 structure.
  */
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  ssd1306_config_async(ssd);
+  ssd1306_wait(ssd);
+}
+
+/**
+ * @brief Start sending the configuration sequence to the SSD1306 display.
+ * 
+ * The whole sequence goes out as a single command stream instead of one
+ * transaction per byte. With DMA enabled it runs in the background and the
+ * next command or flush waits for it, so slow setup elsewhere can overlap.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ */
+void ssd1306_config_async(ssd1306_t *ssd) {
+  ssd1306_wait(ssd);
+  size_t n = ssd1306_config_commands(ssd, ssd->cmd_buffer + 1);
+  ssd1306_write_commands(ssd, ssd->cmd_buffer + 1, n, true);
 }
 
 /**
@@ -63,35 +347,118 @@ void ssd1306_config(ssd1306_t *ssd) {
  * @param command Command to send.
  */
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  ssd1306_wait(ssd);
+  ssd->cmd_buffer[1] = command;
+  ssd1306_write_commands(ssd, ssd->cmd_buffer + 1, 1, false);
 }
 
 /**
  * @brief Send data to the SSD1306 display.
  * 
+ * Blocks until the whole frame has been transferred.
+ * 
  * @param ssd Pointer to the SSD1306 structure.
  */
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  ssd1306_send_data_async(ssd);
+  ssd1306_wait(ssd);
+}
+
+/**
+ * @brief Start sending data to the SSD1306 display.
+ * 
+ * With DMA enabled the transfer runs in the background; poll it with
+ * ssd1306_busy() or block on ssd1306_wait(). On SPI the RAM buffer is read
+ * directly and must not be modified until then. Without DMA this is the
+ * same as ssd1306_send_data(). Displays on the same bus must not have
+ * overlapping flushes; use ssd1306_same_bus() to serialise them.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ */
+void ssd1306_send_data_async(ssd1306_t *ssd) {
+  ssd1306_wait(ssd);
+  ssd->flush_start_us = time_us_32();
+  ssd1306_set_window(ssd, 0, ssd->width - 1);
+  ssd1306_write_data(ssd, ssd->ram_buffer + 1, ssd->bufsize - 1, true);
+}
+
+/**
+ * @brief Send a range of columns to the SSD1306 display.
+ * 
+ * In vertical addressing mode each column is a contiguous run of pages in
+ * the RAM buffer, so a column range goes out as a single transfer. Always
+ * blocking.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @param x0 First column to send.
+ * @param x1 Last column to send (inclusive), clamped to the display width.
+ *           Nothing is sent when x0 > x1.
+ */
+void ssd1306_send_columns(ssd1306_t *ssd, uint8_t x0, uint8_t x1) {
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  if (x0 > x1)
+    return;
+
+  uint8_t *slice = ssd->ram_buffer + ssd1306_offset(ssd, x0, 0);
+  size_t len = (size_t)(x1 - x0 + 1) * ssd->pages;
+
+  ssd1306_wait(ssd);
+  ssd->flush_start_us = time_us_32();
+  ssd1306_set_window(ssd, x0, x1);
+  ssd1306_write_data(ssd, slice, len, false);
+}
+
+/**
+ * @brief Check whether a background flush is still running.
+ * 
+ * Once the transfer has drained this releases the bus, so it is safe to
+ * call from a polling loop.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ * @return true while the display is still receiving the last frame.
+ */
+bool ssd1306_busy(ssd1306_t *ssd) {
+  if (!ssd->in_flight)
+    return false;
+  if (dma_channel_is_busy(ssd->dma_chan))
+    return true;
+
+  if (ssd->transport == SSD1306_TRANSPORT_SPI) {
+    if (spi_is_busy(ssd->spi_port))
+      return true;
+
+    // O DMA só escreve no TX; descarta o que chegou no RX e limpa o overrun
+    while (spi_is_readable(ssd->spi_port))
+      (void)spi_get_hw(ssd->spi_port)->dr;
+    spi_get_hw(ssd->spi_port)->icr = SPI_SSPICR_RORIC_BITS;
+    gpio_put(ssd->cs_pin, 1);
+  } else {
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    if (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+      return true;
+
+    // Um NACK aborta a transmissão e descarta o resto do FIFO; limpa o aborto e contabiliza o erro
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+      (void)hw->clr_tx_abrt;
+      ++ssd->flush_errors;
+    }
+  }
+
+  ssd->in_flight = false;
+  if (ssd->in_flight_frame)
+    ssd1306_flush_done(ssd);
+  return false;
+}
+
+/**
+ * @brief Wait for a background flush to finish and release the bus.
+ * 
+ * @param ssd Pointer to the SSD1306 structure.
+ */
+void ssd1306_wait(ssd1306_t *ssd) {
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
 }
 
 /**
@@ -103,7 +470,7 @@ void ssd1306_send_data(ssd1306_t *ssd) {
  * @param value Pixel value (true for on, false for off).
  */
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  size_t index = ssd1306_offset(ssd, x, y >> 3);
   uint8_t pixel = (y & 0b111);
   if (value)
     ssd->ram_buffer[index] |= (1 << pixel);
@@ -1,9 +1,11 @@
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/spi.h"
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_CMD_BUFSIZE 32
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -25,19 +27,40 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+typedef enum {
+  SSD1306_TRANSPORT_I2C,
+  SSD1306_TRANSPORT_SPI
+} ssd1306_transport_t;
+
 typedef struct {
   uint8_t width, height, pages, address;
+  ssd1306_transport_t transport;
   i2c_inst_t *i2c_port;
+  spi_inst_t *spi_port;
+  uint cs_pin, dc_pin;
+  int dma_chan;
+  uint16_t *dma_words;
+  bool in_flight, in_flight_frame;
+  uint32_t flush_start_us, flush_last_us, flush_count, flush_errors;
+  uint64_t flush_total_us;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
-  uint8_t port_buffer[2];
+  uint8_t cmd_buffer[SSD1306_CMD_BUFSIZE];
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init_spi(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, spi_inst_t *spi, uint cs_pin, uint dc_pin);
+void ssd1306_enable_dma(ssd1306_t *ssd);
+bool ssd1306_same_bus(const ssd1306_t *a, const ssd1306_t *b);
 void ssd1306_config(ssd1306_t *ssd);
+void ssd1306_config_async(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_send_data_async(ssd1306_t *ssd);
+void ssd1306_send_columns(ssd1306_t *ssd, uint8_t x0, uint8_t x1);
+bool ssd1306_busy(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -8,9 +8,18 @@
 #include "hardware/pio.h"      // Inclusão da biblioteca de funções do PIO
 #include "hardware/clocks.h"  // Inclusão da biblioteca de funções de clock
 #include "hardware/i2c.h"    // Inclusão da biblioteca de funções do I2C
+#include "hardware/spi.h"   // Inclusão da biblioteca de funções do SPI
+#include "hardware/dma.h"   // Inclusão da biblioteca de funções do DMA
+#include "hardware/irq.h"   // Inclusão da biblioteca de funções de interrupção
+#include "hardware/sync.h"  // Inclusão da biblioteca de funções de sincronização (__wfi)
+#if LIB_PICO_STDIO_USB
+#include "pico/stdio_usb.h" // Inclusão da biblioteca da serial por USB (stdio_usb_connected)
+#endif
 #include "ws2812.pio.h"     // Inclusão da biblioteca de funções do WS2812B
 #include "inc/ssd1306.h"   // Inclusão da biblioteca de funções de display e configuração do OLED
 #include "inc/font.h"     // Inclusão da biblioteca de funções de fonte
+#include "inc/bench.h"     // Inclusão da biblioteca de medição de desempenho
+#include "inc/font_matrix.h" // Inclusão da fonte reduzida para a matriz de LEDs (gerada a partir de font.h)
 
 // Definições de constantes utilizadas no programa
 #define IS_RGBW false          // Define se a matriz é RGB ou RGBW
@@ -23,6 +32,63 @@
 #define I2C_SCL 15      // Define o pino SCL
 #define ENDERECO 0x3C  // Endereço do display OLED
 
+// Exibição de um quadro na matriz: o último pixel sai do registrador de deslocamento do PIO e a linha fica em nível baixo até o latch
+#define WS2812_PIXEL_US 30      // Duração de um pixel de 24 bits a 800 kHz
+#define WS2812_RESET_US 300    // Tempo de reset (latch) do WS2812B-V5
+
+// Ligação alternativa do display OLED por SPI de 4 fios (SCK, MOSI, CS e D/C)
+#define OLED_USE_SPI 0                  // 1 para usar o SPI no lugar do I2C
+#define SPI_PORT spi0                  // Define a porta SPI utilizada
+#define SPI_SCK 18                    // Define o pino de clock
+#define SPI_MOSI 19                  // Define o pino de dados
+#define SPI_CS 17                   // Define o pino de chip select
+#define SPI_DC 16                  // Define o pino de dado/comando
+#define SPI_BAUD (10 * 1000 * 1000) // Clock do SPI em Hz (10 MHz)
+
+// Displays OLED: o de status (acima) e o de detalhes, no mesmo barramento com outro endereço ou em outra porta I2C
+#define NUM_DISPLAYS 2                  // Quantidade de displays OLED
+#define DISPLAY_STATUS 0               // Índice do display de status
+#define DISPLAY_DETALHE 1             // Índice do display de detalhes
+// Os pinos devem mudar junto com a porta: GPIO14/15 só servem ao i2c1; para o i2c0 use, por exemplo, GPIO20/21
+#define DETALHE_I2C_PORT i2c1        // Porta I2C do display de detalhes (i2c0 ou i2c1)
+#define DETALHE_SDA 14              // Pino SDA do display de detalhes (SDA da porta escolhida)
+#define DETALHE_SCL 15             // Pino SCL do display de detalhes (SCL da porta escolhida)
+#define DETALHE_ENDERECO 0x3D     // Endereço do display de detalhes
+
+// Modo de benchmark (comando '#' ou botões A e B pressionados na inicialização)
+#define BENCH_AMOSTRAS 100      // Quantidade de amostras por carga de trabalho
+#define BENCH_COLUNAS 16       // Quantidade de colunas do envio parcial do display
+#define BENCH_LOOP_OUT 8      // Pino de saída do loopback da medição de latência da IRQ
+#define BENCH_LOOP_IN 9      // Pino de entrada do loopback (ligado por um jumper ao BENCH_LOOP_OUT)
+#define BENCH_USB_ESPERA_MS 5000 // Espera máxima pela conexão do USB antes do benchmark da inicialização
+
+// Eventos que acordam o laço principal
+#define EVENTO_SERIAL (1u << 0) // Caracteres disponíveis na UART/USB
+#define EVENTO_BOTAO (1u << 1)  // Botão pressionado
+#define EVENTO_TICK (1u << 2)   // Tique do temporizador
+#define EVENTO_DMA (1u << 3)    // Fim de uma transferência DMA dos displays
+#define TICK_MS 1000            // Período do tique, que também é a janela do relatório de utilização
+
+// Letreiro na matriz de LEDs (comando '>' seguido do texto e Enter)
+#define MATRIZ_LADO 5                                                             // Quantidade de linhas e colunas da matriz
+#define MARQUEE_MAX_CHARS 64                                                     // Tamanho máximo da mensagem
+#define MARQUEE_MAX_COLUNAS (MATRIZ_LADO + MARQUEE_MAX_CHARS * (FONT_MATRIX_MAX_WIDTH + 1)) // Espaço inicial e glifos com uma coluna de separação
+#define MARQUEE_PERIODO_MS 150                                                 // Período inicial de cada passo do letreiro
+#define MARQUEE_PERIODO_MIN_MS 20                                             // Período mínimo (comando '+')
+#define MARQUEE_PERIODO_MAX_MS 1000                                          // Período máximo (comando '-')
+
+// Fases da inicialização, com o instante de término de cada uma registrado em boot_us
+typedef enum {
+    BOOT_MAIN,             // Entrada em main, após a inicialização do runtime
+    BOOT_STDIO,            // Serial inicializada
+    BOOT_GPIO,             // LEDs, botões e loopback configurados
+    BOOT_OLED_CONFIG,      // Barramentos prontos e configuração dos displays iniciada
+    BOOT_MATRIZ,           // Programa do WS2812B carregado no PIO
+    BOOT_PRIMEIRO_QUADRO,  // Primeiro quadro exibido na matriz de LEDs (FIFO do PIO vazio e latch)
+    BOOT_OLED_PRONTO,      // Displays configurados e limpos
+    BOOT_FASES
+} boot_fase_t;
+
 // Pinos para controle do LED e botões
 const uint ledRed_pin = 13;     // Red => GPIO13
 const uint ledBlue_pin = 12;   // Blue => GPIO12
@@ -30,7 +96,15 @@ const uint ledGreen_pin = 11; // Green => GPIO11
 const uint button_A = 5;     // Botão A => GPIO5
 const uint button_B = 6;    // Botão B => GPIO6
 
-ssd1306_t ssd; // Inicializa a estrutura do display
+ssd1306_t ssd;         // Inicializa a estrutura do display de status
+ssd1306_t ssd_detalhe; // Inicializa a estrutura do display de detalhes
+
+// Variáveis globais para o agendamento do envio dos quadros aos displays
+ssd1306_t *displays[NUM_DISPLAYS] = { &ssd, &ssd_detalhe }; // Displays indexados por DISPLAY_STATUS e DISPLAY_DETALHE
+bool display_presente[NUM_DISPLAYS] = { false };           // Display respondeu durante a inicialização
+bool display_pendente[NUM_DISPLAYS] = { false };          // Quadro desenhado aguardando envio
+static uint32_t relatorio_inicio_us = 0;                 // Início da janela do relatório de taxa de atualização
+static uint32_t relatorio_quadros = 0;                  // Quadros enviados até o início da janela
 
 // Variáveis globais para controle do LED e cor
 uint8_t displayed_number = 0;      // Índice do LED a ser controlado (0 a 24)
@@ -41,6 +115,53 @@ uint8_t selected_b = 255;       // Intensidade do azul (0 a 255)
 // Variáveis globais para controle do tempo
 static volatile uint32_t last_time = 0; // Armazena o tempo do último evento (em microssegundos)
 
+// Variáveis globais para a medição de latência da IRQ no benchmark
+static volatile uint32_t bench_irq_ciclos = 0;    // Contador do SysTick na entrada da interrupção
+static volatile bool bench_irq_recebida = false; // Indica que a interrupção do loopback ocorreu
+
+// Variáveis globais para o laço orientado a eventos
+static volatile uint32_t eventos = 0;          // Eventos pendentes (EVENTO_*), definidos pelas interrupções
+static volatile uint32_t botoes_pendentes = 0; // Máscara das GPIOs dos botões pressionados
+static repeating_timer_t timer_tick;           // Temporizador do tique
+
+// Subsistemas contabilizados na utilização da CPU
+typedef enum {
+    UTIL_SERIAL,  // Tratamento dos comandos seriais
+    UTIL_BOTOES,  // Tratamento dos botões
+    UTIL_OLED,    // Envio dos quadros aos displays
+    UTIL_MATRIZ,  // Envio dos quadros à matriz de LEDs
+    UTIL_OUTROS,  // Laço principal e interrupções fora dos subsistemas acima
+    UTIL_OCIOSO,  // Núcleo dormindo em __wfi
+    UTIL_TOTAL
+} util_subsistema_t;
+
+static const char *util_nomes[UTIL_TOTAL] = { "serial", "botoes", "oled", "matriz", "outros", "ocioso" };
+static uint32_t util_us[UTIL_TOTAL] = { 0 };        // Tempo por subsistema na janela atual
+static uint32_t util_janela_us[UTIL_TOTAL] = { 0 }; // Tempo por subsistema na última janela fechada
+static uint32_t util_duracao_janela = 0;           // Duração da última janela fechada
+static util_subsistema_t util_atual = UTIL_OUTROS; // Subsistema que está usando a CPU
+static uint32_t util_marca = 0;                    // Instante da última troca de subsistema
+
+// Variáveis globais para o letreiro
+static uint8_t marquee_colunas[MARQUEE_MAX_COLUNAS];  // Mensagem compilada em um fluxo de colunas (bit 0 = linha de cima)
+static uint16_t marquee_total = 0;                     // Quantidade de colunas do fluxo
+static volatile uint16_t marquee_posicao = 0;          // Primeira coluna da janela exibida
+static uint32_t marquee_quadro[NUM_PIXELS];            // Quadro enviado à matriz por DMA, já no formato do PIO
+static int marquee_dma = -1;                           // Canal DMA que alimenta o PIO
+static repeating_timer_t timer_marquee;                // Temporizador dos passos do letreiro
+static bool marquee_ativo = false;                     // Letreiro rolando na matriz
+static bool marquee_lendo = false;                     // Recebendo o texto do letreiro pela serial
+static char marquee_texto[MARQUEE_MAX_CHARS + 1];      // Texto do letreiro
+static uint8_t marquee_tamanho = 0;                    // Quantidade de caracteres recebidos
+static uint32_t marquee_periodo_ms = MARQUEE_PERIODO_MS; // Período atual de cada passo
+static volatile uint32_t marquee_ultimo_us = 0;        // Instante do último passo
+static volatile uint32_t marquee_jitter_max_us = 0;    // Maior desvio do período entre dois passos
+static volatile uint32_t marquee_passos = 0;           // Passos exibidos desde o início do letreiro
+
+// Variáveis globais para a instrumentação da inicialização
+static const char *boot_nomes[BOOT_FASES] = { "main", "stdio", "gpio", "oled_config", "matriz", "primeiro_quadro", "oled_pronto" };
+static uint32_t boot_us[BOOT_FASES] = { 0 }; // Instante de término de cada fase, em microssegundos desde o reset
+
 // Buffer para armazenar as cores de todos os LEDs
 // Cada coluna representa um número de 0 a 9
 bool led_buffer[NUMBERS][NUM_PIXELS] = {
@@ -118,11 +239,25 @@ bool led_buffer[NUMBERS][NUM_PIXELS] = {
 // Prototipação das funções utilizadas no programa
 
 /**
- * @brief Inicializa os componentes necessários.
+ * @brief Inicializa os componentes necessários, cada um uma única vez.
+ * 
+ * A configuração dos displays é enviada por DMA enquanto o PIO é configurado e o primeiro quadro da matriz é enviado.
  * 
  * @return true se a inicialização for bem-sucedida, false caso contrário.
  */
-bool init_components();                                                            
+bool init_components();
+
+/**
+ * @brief Registra o término de uma fase da inicialização.
+ * 
+ * @param fase A fase concluída.
+ */
+void boot_marcar(boot_fase_t fase);
+
+/**
+ * @brief Exibe pela serial o instante de cada fase da inicialização e o tempo até o primeiro quadro.
+ */
+void boot_relatorio();                                                            
 
 /**
  * @brief Função de interrupção com debouncing.
@@ -132,6 +267,13 @@ bool init_components();
  */
 static void gpio_irq_handler(uint gpio, uint32_t events);                         
 
+/**
+ * @brief Interrupção do loopback do benchmark, registrada direto no banco de GPIOs.
+ * 
+ * Lê o SysTick antes de qualquer outra instrução, sem passar pelo despacho de callbacks do SDK.
+ */
+static void bench_irq_handler(void);
+
 /**
  * @brief Envia um pixel para a matriz de LEDs.
  * 
@@ -159,6 +301,168 @@ static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b);
  */
 void set_led_pattern(uint8_t r, uint8_t g, uint8_t b, int displayed_number);
 
+/**
+ * @brief Aguarda a matriz exibir o quadro enviado: o FIFO do PIO esvazia e o tempo de reset do WS2812 passa.
+ */
+void matriz_aguardar_quadro();
+
+/**
+ * @brief Verifica se há um display respondendo no endereço I2C.
+ * 
+ * @param porta A porta I2C do display.
+ * @param endereco O endereço do display.
+ * @return true se o display reconheceu o endereço, false caso contrário.
+ */
+bool display_detectar(i2c_inst_t *porta, uint8_t endereco);
+
+/**
+ * @brief Marca o quadro de um display para envio.
+ * 
+ * @param indice O índice do display (DISPLAY_STATUS ou DISPLAY_DETALHE).
+ */
+void display_agendar(uint8_t indice);
+
+/**
+ * @brief Avança o envio dos quadros pendentes sem bloquear.
+ * 
+ * Displays em barramentos diferentes são atualizados ao mesmo tempo; displays no mesmo barramento, um de cada vez.
+ * 
+ * @return true se ainda há quadros pendentes ou em envio, false caso contrário.
+ */
+bool display_servico();
+
+/**
+ * @brief Envia todos os quadros pendentes e aguarda o término.
+ */
+void display_flush_todos();
+
+/**
+ * @brief Exibe pela serial o tempo de envio de cada display e a taxa de atualização agregada.
+ */
+void display_relatorio();
+
+/**
+ * @brief Prepara o buffer de um display para ser desenhado.
+ * 
+ * No SPI o DMA lê direto do buffer, então aguarda o envio em andamento; no I2C o quadro é copiado ao iniciar o envio.
+ * 
+ * @param indice O índice do display (DISPLAY_STATUS ou DISPLAY_DETALHE).
+ */
+void display_preparar(uint8_t indice);
+
+/**
+ * @brief Verifica se algum display está com uma transferência DMA em andamento.
+ * 
+ * @return true se o fim do envio será avisado pela interrupção do DMA, false caso contrário.
+ */
+bool display_em_dma();
+
+/**
+ * @brief Trata o fim das transferências DMA dos displays.
+ */
+void dma_irq_handler();
+
+/**
+ * @brief Avisa o laço principal que há caracteres disponíveis na serial.
+ * 
+ * @param param Não utilizado.
+ */
+void serial_callback(void *param);
+
+/**
+ * @brief Gera o tique periódico do laço principal.
+ * 
+ * @param t O temporizador que gerou o tique.
+ * @return true para manter o temporizador ativo.
+ */
+bool tick_callback(repeating_timer_t *t);
+
+/**
+ * @brief Dorme em __wfi até que uma interrupção sinalize um evento.
+ * 
+ * @param pode_dormir false quando há trabalho a sondar e o núcleo não deve dormir.
+ * @return A máscara de eventos pendentes, que é zerada.
+ */
+uint32_t aguardar_eventos(bool pode_dormir);
+
+/**
+ * @brief Trata o botão pressionado, fora do contexto de interrupção.
+ * 
+ * @param gpio O pino GPIO do botão.
+ */
+void tratar_botao(uint gpio);
+
+/**
+ * @brief Passa a contabilizar o tempo de CPU para um subsistema.
+ * 
+ * @param subsistema O subsistema que passa a usar a CPU.
+ * @return O subsistema anterior, a ser restaurado com util_sair().
+ */
+util_subsistema_t util_entrar(util_subsistema_t subsistema);
+
+/**
+ * @brief Volta a contabilizar o tempo de CPU para o subsistema anterior.
+ * 
+ * @param anterior O valor retornado por util_entrar().
+ */
+void util_sair(util_subsistema_t anterior);
+
+/**
+ * @brief Fecha a janela de contabilização e guarda o resultado para o relatório.
+ */
+void util_fechar_janela();
+
+/**
+ * @brief Exibe pela serial a utilização da CPU por subsistema na última janela.
+ */
+void util_relatorio();
+
+/**
+ * @brief Converte a posição na matriz para o índice do LED na cadeia WS2812B.
+ * 
+ * A cadeia começa no canto inferior direito e percorre as linhas em zigue-zague, como em led_buffer.
+ * 
+ * @param x A coluna, da esquerda para a direita (0 a 4).
+ * @param y A linha, de cima para baixo (0 a 4).
+ * @return O índice do LED (0 a 24).
+ */
+static inline uint8_t matriz_indice(uint8_t x, uint8_t y);
+
+/**
+ * @brief Compila o texto em um fluxo de colunas com os glifos de font_matrix.
+ * 
+ * @param texto O texto a ser exibido.
+ */
+void marquee_compilar(const char *texto);
+
+/**
+ * @brief Inicia a rolagem do texto compilado na matriz.
+ */
+void marquee_iniciar();
+
+/**
+ * @brief Para a rolagem e aguarda o envio do último quadro.
+ */
+void marquee_parar();
+
+/**
+ * @brief Exibe o próximo passo do letreiro: desloca a janela e envia o quadro por DMA.
+ * 
+ * Roda na interrupção do temporizador, então o ritmo não depende do laço principal nem do desenho no OLED.
+ * 
+ * @param t O temporizador que gerou o passo.
+ * @return true para manter o temporizador ativo.
+ */
+bool marquee_callback(repeating_timer_t *t);
+
+/**
+ * @brief Executa as cargas de trabalho de referência e exibe os histogramas pela serial.
+ * 
+ * Mede o envio completo e parcial do display, o desenho de texto, o envio de um quadro da matriz e a latência da
+ * interrupção de GPIO pelo loopback entre BENCH_LOOP_OUT e BENCH_LOOP_IN.
+ */
+void executar_benchmark();
+
 /**
  * @brief Processa o comando recebido.
  * 
@@ -167,32 +471,75 @@ void set_led_pattern(uint8_t r, uint8_t g, uint8_t b, int displayed_number);
 void processar_comando(char comando);
 
 int main() {
+    boot_marcar(BOOT_MAIN);
     stdio_init_all(); // Inicializa a comunicação serial
+    boot_marcar(BOOT_STDIO);
 
-    init_components();                                    // Inicializa os componentes
-    if(!init_components()){                              // Verifica se os componentes foram inicializados corretamente
+    if(!init_components()){                              // Inicializa os componentes e verifica se foram inicializados corretamente
         printf("Erro ao inicializar os componentes\n"); // Caso não sejam, exibe uma mensagem de erro
         return 1;
     }
 
-    char entrada_usuario;  // Buffer para armazenar a entrada do usuário.
-
-    PIO pio = pio0;                                        // Define o PIO utilizado
-    int sm = 0;                                           // Define o state machine utilizada
-    uint offset = pio_add_program(pio, &ws2812_program); // Adiciona o programa ao PIO
-
-    ws2812_program_init(pio, sm, offset, WS2812_PIN, 800000, IS_RGBW); // Inicializa o programa do WS2812B
-
     // Configuração da interrupção com callback
     gpio_set_irq_enabled_with_callback(button_A, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler);  // Habilita a interrupção no botão A
     gpio_set_irq_enabled_with_callback(button_B, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler); // Habilita a interrupção no botão B
 
-    set_led_pattern(selected_r, selected_g, selected_b, displayed_number); // Define o padrão inicial dos LEDs, começando com o número 0
+    if (!gpio_get(button_A) && !gpio_get(button_B)) { // Botões A e B pressionados na inicialização entram no modo de benchmark
+#if LIB_PICO_STDIO_USB
+        // O USB ainda não foi enumerado; sem esperar, o relatório se perderia
+        for (uint32_t espera = 0; !stdio_usb_connected() && espera < BENCH_USB_ESPERA_MS; espera += 10)
+            sleep_ms(10);
+#endif
+        executar_benchmark();
+    }
+
+    // Fontes de eventos do laço principal
+    stdio_set_chars_available_callback(serial_callback, NULL);          // Caracteres recebidos pela UART/USB
+    add_repeating_timer_ms(TICK_MS, tick_callback, NULL, &timer_tick); // Tique periódico
+    for (uint8_t i = 0; i < NUM_DISPLAYS; i++) {                      // Fim dos envios por DMA
+        if (display_presente[i] && displays[i]->dma_chan >= 0)
+            dma_channel_set_irq0_enabled(displays[i]->dma_chan, true);
+    }
+    irq_set_exclusive_handler(DMA_IRQ_0, dma_irq_handler);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    eventos |= EVENTO_SERIAL;   // Lê o que já chegou antes do callback ser registrado
+    for (uint8_t i = 0; i < UTIL_TOTAL; i++) // Descarta o tempo contabilizado durante a inicialização
+        util_us[i] = 0;
+    util_marca = time_us_32(); // Inicia a contabilização da utilização
+
+    bool pode_dormir = true; // Falso enquanto um envio I2C esvazia o FIFO, o que não gera interrupção
 
     while (true) {
-        if (scanf("%c", &entrada_usuario) != EOF) { // Lê a entrada do usuário
-            processar_comando(entrada_usuario);  // Processa o comando digitado.
+        uint32_t pendentes = aguardar_eventos(pode_dormir); // Dorme até a próxima interrupção
+
+        if (pendentes & EVENTO_SERIAL) {
+            util_subsistema_t anterior = util_entrar(UTIL_SERIAL);
+            int entrada_usuario;                                                     // Caractere recebido
+            while ((entrada_usuario = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) // Lê tudo o que está disponível
+                processar_comando((char)entrada_usuario);                          // Processa o comando digitado.
+            util_sair(anterior);
         }
+
+        if (pendentes & EVENTO_BOTAO) {
+            util_subsistema_t anterior = util_entrar(UTIL_BOTOES);
+            uint32_t estado = save_and_disable_interrupts();
+            uint32_t botoes = botoes_pendentes; // Copia e zera a máscara sem perder botões
+            botoes_pendentes = 0;
+            restore_interrupts(estado);
+            if (botoes & (1u << button_A))
+                tratar_botao(button_A);
+            if (botoes & (1u << button_B))
+                tratar_botao(button_B);
+            util_sair(anterior);
+        }
+
+        util_subsistema_t anterior = util_entrar(UTIL_OLED);
+        pode_dormir = !display_servico() || display_em_dma(); // Conclui e inicia os envios aos displays
+        util_sair(anterior);
+
+        if (pendentes & EVENTO_TICK)
+            util_fechar_janela();
     }
 
     return 0;
@@ -215,6 +562,24 @@ bool init_components(){
     gpio_set_dir(button_B, GPIO_IN);   // Configura o pino como entrada
     gpio_pull_up(button_B);           // Habilita o pull-up interno
 
+    // Loopback e contador de ciclos do benchmark
+    gpio_init(BENCH_LOOP_OUT);                // Inicializa o pino de saída do loopback
+    gpio_set_dir(BENCH_LOOP_OUT, GPIO_OUT);  // Configura o pino como saída
+    gpio_put(BENCH_LOOP_OUT, 0);            // Mantém o loopback em nível baixo
+    gpio_init(BENCH_LOOP_IN);              // Inicializa o pino de entrada do loopback
+    gpio_set_dir(BENCH_LOOP_IN, GPIO_IN); // Configura o pino como entrada
+    gpio_pull_down(BENCH_LOOP_IN);       // Evita bordas falsas sem o jumper
+    gpio_add_raw_irq_handler(BENCH_LOOP_IN, bench_irq_handler); // Fora do callback compartilhado dos botões
+    bench_init();                       // Inicia o SysTick como contador de ciclos
+    boot_marcar(BOOT_GPIO);
+
+#if OLED_USE_SPI
+    // SPI inicialização e configuração do display OLED SSD1306 128x64 pixels a 10 MHz, com envio do quadro por DMA
+    spi_init(SPI_PORT, SPI_BAUD);                                         // Inicializa o SPI
+    gpio_set_function(SPI_SCK, GPIO_FUNC_SPI);                           // Set the GPIO pin function to SPI
+    gpio_set_function(SPI_MOSI, GPIO_FUNC_SPI);                         // Set the GPIO pin function to SPI
+    ssd1306_init_spi(&ssd, WIDTH, HEIGHT, false, SPI_PORT, SPI_CS, SPI_DC); // Inicializa o display OLED
+#else
     // I2C inicialização e configuração do display OLED SSD1306 128x64 pixels com endereço 0x3C e 400 KHz
     ssd1306_init(&ssd, WIDTH, HEIGHT, false, ENDERECO, I2C_PORT); // Inicializa o display OLED
     i2c_init(I2C_PORT, 400 * 1000); // Inicializa o I2C com 400 KHz
@@ -223,13 +588,67 @@ bool init_components(){
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C); // Set the GPIO pin function to I2C
     gpio_pull_up(I2C_SDA);                    // Pull up the data line
     gpio_pull_up(I2C_SCL);                   // Pull up the clock line
-    ssd1306_config(&ssd);                   // Configura o display
-    ssd1306_send_data(&ssd);               // Envia os dados para o display
+#endif
+    display_presente[DISPLAY_STATUS] = true; // O display de status é obrigatório
+    ssd1306_enable_dma(&ssd);               // Envia o quadro em segundo plano
+
+    // Display de detalhes. Inicializa a porta I2C apenas se ela ainda não foi inicializada pelo display de status
+    if (OLED_USE_SPI || DETALHE_I2C_PORT != I2C_PORT) {
+        i2c_init(DETALHE_I2C_PORT, 400 * 1000);          // Inicializa o I2C com 400 KHz
+        gpio_set_function(DETALHE_SDA, GPIO_FUNC_I2C);  // Set the GPIO pin function to I2C
+        gpio_set_function(DETALHE_SCL, GPIO_FUNC_I2C); // Set the GPIO pin function to I2C
+        gpio_pull_up(DETALHE_SDA);                    // Pull up the data line
+        gpio_pull_up(DETALHE_SCL);                   // Pull up the clock line
+    }
+    ssd1306_init(&ssd_detalhe, WIDTH, HEIGHT, false, DETALHE_ENDERECO, DETALHE_I2C_PORT); // Inicializa o display de detalhes
+    display_presente[DISPLAY_DETALHE] = display_detectar(DETALHE_I2C_PORT, DETALHE_ENDERECO); // Detecta antes de ocupar o barramento com DMA
+    if (display_presente[DISPLAY_DETALHE])
+        ssd1306_enable_dma(&ssd_detalhe); // Envia o quadro em segundo plano
+
+    // Inicia a configuração dos displays em segundo plano. No mesmo barramento o display de detalhes espera o de status
+    bool detalhe_compartilhado = ssd1306_same_bus(&ssd, &ssd_detalhe);
+    ssd1306_config_async(&ssd);
+    if (display_presente[DISPLAY_DETALHE] && !detalhe_compartilhado)
+        ssd1306_config_async(&ssd_detalhe);
+    boot_marcar(BOOT_OLED_CONFIG);
+
+    // Matriz de LEDs, configurada enquanto o DMA envia a configuração dos displays
+    PIO pio = pio0;                                        // Define o PIO utilizado
+    int sm = 0;                                           // Define o state machine utilizada
+    uint offset = pio_add_program(pio, &ws2812_program); // Adiciona o programa ao PIO
+    ws2812_program_init(pio, sm, offset, WS2812_PIN, 800000, IS_RGBW); // Inicializa o programa do WS2812B
 
-    // Limpa o display. O display inicia com todos os pixels apagados.
-    ssd1306_fill(&ssd, false); // Limpa o display
-    ssd1306_send_data(&ssd);  // Atualiza o display
+    // Canal DMA do letreiro, que envia o quadro inteiro ao FIFO do PIO sem ocupar a CPU
+    marquee_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(marquee_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(marquee_dma, &c, &pio->txf[sm], marquee_quadro, NUM_PIXELS, false);
+    boot_marcar(BOOT_MATRIZ);
 
+    set_led_pattern(selected_r, selected_g, selected_b, displayed_number); // Define o padrão inicial dos LEDs, começando com o número 0
+    matriz_aguardar_quadro();                                             // A configuração dos displays segue por DMA enquanto isso
+    boot_marcar(BOOT_PRIMEIRO_QUADRO);
+
+    if (display_presente[DISPLAY_DETALHE] && detalhe_compartilhado) {
+        ssd1306_wait(&ssd);           // Libera o barramento compartilhado
+        ssd1306_config(&ssd_detalhe); // Configura o display de detalhes
+    }
+
+    // Limpa os displays. Os buffers já começam zerados, então basta um envio de cada display
+    display_agendar(DISPLAY_STATUS);        // Agenda o envio do display de status
+    display_agendar(DISPLAY_DETALHE);      // Agenda o envio do display de detalhes
+    display_flush_todos();                // Atualiza os displays, após o fim da configuração de cada um
+    boot_marcar(BOOT_OLED_PRONTO);
+
+    // Inicia a janela do relatório de taxa de atualização, descontando os envios de limpeza acima
+    relatorio_inicio_us = time_us_32();
+    relatorio_quadros = 0;
+    for (uint8_t i = 0; i < NUM_DISPLAYS; i++)
+        if (display_presente[i])
+            relatorio_quadros += displays[i]->flush_count;
     return true;
 }
 
@@ -241,70 +660,88 @@ static inline void put_pixel(uint32_t pixel_grb) {
     pio_sm_put_blocking(pio0, 0, pixel_grb << 8u); // Envia o valor do pixel para o PIO de forma bloqueante, deslocando 8 bits para a esquerda
 }
 
+static void bench_irq_handler(void) {
+    bench_irq_ciclos = bench_cycles();                      // Registra o contador antes de tudo
+    gpio_acknowledge_irq(BENCH_LOOP_IN, GPIO_IRQ_EDGE_RISE); // Handler bruto: a borda é reconhecida aqui
+    bench_irq_recebida = true;
+}
+
 // Função de interrupção com debouncing
 void gpio_irq_handler(uint gpio, uint32_t events)
 {
     // Obtém o tempo atual em microssegundos
     uint32_t current_time = to_us_since_boot(get_absolute_time()); // Obtém o tempo atual em microssegundos
-    bool state = false; // Estado do LED
 
     // Verifica se passou tempo suficiente desde o último evento, para evitar o debouncing
     if (current_time - last_time > 200000) // 200 ms de debouncing
     {
         last_time = current_time; // Atualiza o tempo do último evento
 
-        // Verifica qual botão foi pressionado, com base na GPIO de entrada, e atualiza o estado do LED que está relacionado a ele
-        switch (gpio){
-        case 5:
-            state = gpio_get(ledGreen_pin); // Obtém o estado do LED verde
-            printf("Botão A pressionado\n");
-            printf("Mudando o estado do LED verde\n");
-            if(!state) // Verifica se o LED está ligado
-            {
-                printf("LED verde ligado\n");
-                ssd1306_fill(&ssd, false);                        // Limpa o display
-                ssd1306_draw_string(&ssd, "LED VERDE", 0, 0); // Desenha uma string
-                ssd1306_draw_string(&ssd, "LIGADO", 0, 20);     // Desenha uma string
-            }
-            else // Caso o LED esteja desligado
-            {
-                printf("LED verde desligado\n");
-                ssd1306_fill(&ssd, false);                        // Limpa o display
-                ssd1306_draw_string(&ssd, "LED VERDE", 0, 0); // Desenha uma string
-                ssd1306_draw_string(&ssd, "DESLIGADO", 0, 20);  // Desenha uma string
-            }
-            gpio_put(ledGreen_pin, !state); // Muda o estado do LED verde
-            ssd1306_send_data(&ssd); // Atualiza o display
-            break;
-        case 6:
-            state = gpio_get(ledBlue_pin); // Obtém o estado do LED azul
-            printf("Botão b pressionado\n");
-            printf("Mudando o estado do LED azul\n");
-            if(!state) // Verifica se o LED está ligado
-            {
-                printf("LED azul ligado\n");
-                ssd1306_fill(&ssd, false); // Limpa o display
-                ssd1306_draw_string(&ssd, "LED AZUL     ", 0, 0); // Desenha uma string
-                ssd1306_draw_string(&ssd, "LIGADO", 0, 20); // Desenha uma string
-            }
-            else // Caso o LED esteja desligado
-            {
-                printf("LED azul desligado\n");
-                ssd1306_fill(&ssd, false);                         // Limpa o display
-                ssd1306_draw_string(&ssd, "LED AZUL     ", 0, 0); // Desenha uma string
-                ssd1306_draw_string(&ssd, "DESLIGADO", 0, 20);   // Desenha uma string
-            }
-            gpio_put(ledBlue_pin, !state); // Muda o estado do LED azul
-            ssd1306_send_data(&ssd);      // Atualiza o display
-            break;
-        default:
-            break;
-        }        
+        // O tratamento do botão é feito pelo laço principal, fora da interrupção
+        botoes_pendentes |= 1u << gpio;
+        eventos |= EVENTO_BOTAO;
+    }
+}
+
+void tratar_botao(uint gpio)
+{
+    bool state = false; // Estado do LED
+
+    // Verifica qual botão foi pressionado, com base na GPIO de entrada, e atualiza o estado do LED que está relacionado a ele
+    switch (gpio){
+    case 5:
+        display_preparar(DISPLAY_STATUS); // Libera o buffer antes de desenhar
+        state = gpio_get(ledGreen_pin); // Obtém o estado do LED verde
+        printf("Botão A pressionado\n");
+        printf("Mudando o estado do LED verde\n");
+        if(!state) // Verifica se o LED está ligado
+        {
+            printf("LED verde ligado\n");
+            ssd1306_fill(&ssd, false);                        // Limpa o display
+            ssd1306_draw_string(&ssd, "LED VERDE", 0, 0); // Desenha uma string
+            ssd1306_draw_string(&ssd, "LIGADO", 0, 20);     // Desenha uma string
+        }
+        else // Caso o LED esteja desligado
+        {
+            printf("LED verde desligado\n");
+            ssd1306_fill(&ssd, false);                        // Limpa o display
+            ssd1306_draw_string(&ssd, "LED VERDE", 0, 0); // Desenha uma string
+            ssd1306_draw_string(&ssd, "DESLIGADO", 0, 20);  // Desenha uma string
+        }
+        gpio_put(ledGreen_pin, !state); // Muda o estado do LED verde
+        display_agendar(DISPLAY_STATUS); // Agenda a atualização do display
+        break;
+    case 6:
+        display_preparar(DISPLAY_STATUS); // Libera o buffer antes de desenhar
+        state = gpio_get(ledBlue_pin); // Obtém o estado do LED azul
+        printf("Botão b pressionado\n");
+        printf("Mudando o estado do LED azul\n");
+        if(!state) // Verifica se o LED está ligado
+        {
+            printf("LED azul ligado\n");
+            ssd1306_fill(&ssd, false); // Limpa o display
+            ssd1306_draw_string(&ssd, "LED AZUL     ", 0, 0); // Desenha uma string
+            ssd1306_draw_string(&ssd, "LIGADO", 0, 20); // Desenha uma string
+        }
+        else // Caso o LED esteja desligado
+        {
+            printf("LED azul desligado\n");
+            ssd1306_fill(&ssd, false);                         // Limpa o display
+            ssd1306_draw_string(&ssd, "LED AZUL     ", 0, 0); // Desenha uma string
+            ssd1306_draw_string(&ssd, "DESLIGADO", 0, 20);   // Desenha uma string
+        }
+        gpio_put(ledBlue_pin, !state); // Muda o estado do LED azul
+        display_agendar(DISPLAY_STATUS); // Agenda a atualização do display
+        break;
+    default:
+        break;
     }
 }
 
 void set_led_pattern(uint8_t r, uint8_t g, uint8_t b, int displayed_number)
 {
+    util_subsistema_t anterior = util_entrar(UTIL_MATRIZ); // Contabiliza o tempo na matriz
+
     // Define a cor com base nos parâmetros fornecidos
     uint32_t color = urgb_u32(r, g, b);
 
@@ -316,24 +753,120 @@ void set_led_pattern(uint8_t r, uint8_t g, uint8_t b, int displayed_number)
         else
             put_pixel(0);  // Desliga os LEDs com zero no buffer
     }
+
+    util_sair(anterior);
+}
+
+void matriz_aguardar_quadro() {
+    while (!pio_sm_is_tx_fifo_empty(pio0, 0)) // Aguarda o PIO consumir o quadro
+        tight_loop_contents();
+    sleep_us(WS2812_PIXEL_US + WS2812_RESET_US); // Último pixel e latch
 }
 
 void processar_comando(char comando) {
+    if(marquee_lendo) // Recebendo o texto do letreiro
+    {
+        if(comando == '\r' || comando == '\n') // Enter encerra o texto
+        {
+            marquee_lendo = false;
+            marquee_texto[marquee_tamanho] = '\0';
+            if(marquee_tamanho == 0)
+                return;
+            printf("Letreiro: %s\n", marquee_texto);
+            display_preparar(DISPLAY_STATUS);                   // Libera o buffer antes de desenhar
+            ssd1306_fill(&ssd, false);                         // Limpa o display
+            ssd1306_draw_string(&ssd, "LETREIRO", 0, 0);      // Desenha uma string
+            ssd1306_draw_string(&ssd, marquee_texto, 0, 20); // Desenha o texto
+            display_agendar(DISPLAY_STATUS);                // Agenda a atualização do display
+            marquee_parar();
+            marquee_compilar(marquee_texto);
+            marquee_iniciar();
+        }
+        else if(marquee_tamanho < MARQUEE_MAX_CHARS)
+            marquee_texto[marquee_tamanho++] = comando;
+        return;
+    }
+    if(comando == '\r' || comando == '\n') // Ignora o fim de linha enviado pelo terminal
+        return;
+    if(comando == '>') // Início do texto do letreiro
+    {
+        printf("Digite o texto do letreiro e tecle Enter\n");
+        marquee_lendo = true;
+        marquee_tamanho = 0;
+        return;
+    }
+    if(comando == '<') // Para o letreiro e volta a exibir o número
+    {
+        if(marquee_ativo)
+            printf("MARQUEE,passos=%lu,periodo_ms=%lu,jitter_max_us=%lu\n",
+                   (unsigned long)marquee_passos, (unsigned long)marquee_periodo_ms, (unsigned long)marquee_jitter_max_us);
+        marquee_parar();
+        set_led_pattern(selected_r, selected_g, selected_b, displayed_number);
+        return;
+    }
+    if(comando == '+' || comando == '-') // Velocidade do letreiro
+    {
+        // Dobra ou reduz à metade a velocidade, limitando o período para que os extremos sejam alcançados
+        if(comando == '+')
+            marquee_periodo_ms = marquee_periodo_ms / 2 < MARQUEE_PERIODO_MIN_MS ? MARQUEE_PERIODO_MIN_MS : marquee_periodo_ms / 2;
+        else
+            marquee_periodo_ms = marquee_periodo_ms * 2 > MARQUEE_PERIODO_MAX_MS ? MARQUEE_PERIODO_MAX_MS : marquee_periodo_ms * 2;
+        printf("Letreiro: %lu ms por coluna\n", (unsigned long)marquee_periodo_ms);
+        if(marquee_ativo) // Reinicia o temporizador com o novo período, mantendo a posição
+        {
+            cancel_repeating_timer(&timer_marquee);
+            marquee_iniciar();
+        }
+        return;
+    }
+    if(comando == '?') // Relatório dos displays
+    {
+        display_relatorio();
+        return;
+    }
+    if(comando == '%') // Relatório de utilização da CPU
+    {
+        util_relatorio();
+        return;
+    }
+    if(comando == '@') // Relatório da inicialização
+    {
+        boot_relatorio();
+        return;
+    }
+    if(comando == '#') // Modo de benchmark
+    {
+        marquee_parar(); // O benchmark usa a matriz
+        executar_benchmark();
+        return;
+    }
     if(!(comando >= '0' && comando <= '9' || comando >= 'A' && comando <= 'Z' || comando >= 'a' && comando <= 'z')) // Verifica se o comando é um número ou uma letra
     {
         printf("Char inválido\n");                        // Exibe uma mensagem de erro
+        display_preparar(DISPLAY_STATUS);                // Libera o buffer antes de desenhar
         ssd1306_fill(&ssd, false);                       // Limpa o display
         ssd1306_draw_string(&ssd, "ERRO", 0, 0);        // Desenha uma string
         ssd1306_draw_string(&ssd, "CHAR", 0, 20);      // Desenha uma string
         ssd1306_draw_string(&ssd, "INVALIDO", 0, 40); // Desenha uma string
-        ssd1306_send_data(&ssd);                     // Atualiza o display
+        display_agendar(DISPLAY_STATUS);             // Agenda a atualização do display
         return;
     }
     printf("Char recebido: %c\n", comando);               // Exibe o comando recebido
+    display_preparar(DISPLAY_STATUS);                    // Libera o buffer antes de desenhar
     ssd1306_fill(&ssd, false);                           // Limpa o display
     ssd1306_draw_string(&ssd, "CHAR RECEBIDO", 0, 0);   // Desenha uma string
     ssd1306_draw_char(&ssd, comando, 60, 32);          // Desenha um caractere
-    ssd1306_send_data(&ssd);                          // Atualiza o display
+    display_agendar(DISPLAY_STATUS);                  // Agenda o envio do display de status
+
+    char linha[17];                                                                      // Linha de texto do display de detalhes
+    display_preparar(DISPLAY_DETALHE);                                                  // Libera o buffer antes de desenhar
+    ssd1306_fill(&ssd_detalhe, false);                                                  // Limpa o display
+    ssd1306_draw_string(&ssd_detalhe, "DETALHES", 0, 0);                               // Desenha uma string
+    snprintf(linha, sizeof(linha), "CODIGO %u", (unsigned)comando);                   // Código ASCII do caractere
+    ssd1306_draw_string(&ssd_detalhe, linha, 0, 20);                                 // Desenha uma string
+    snprintf(linha, sizeof(linha), "FLUSH %luus", (unsigned long)ssd.flush_last_us); // Tempo do último envio do display de status
+    ssd1306_draw_string(&ssd_detalhe, linha, 0, 40);                                // Desenha uma string
+    display_agendar(DISPLAY_DETALHE);                                              // Agenda o envio do display de detalhes
     if(comando >= '0' && comando <= '9')             // Verifica se o comando é um número
     {
         switch(comando)
@@ -371,6 +904,349 @@ void processar_comando(char comando) {
             default:
                 break;
         }
+        marquee_parar();                                                        // O número substitui o letreiro
         set_led_pattern(selected_r, selected_g, selected_b, displayed_number); // Define o padrão dos LEDs
     }
-}
\ No newline at end of file
+}
+
+bool display_detectar(i2c_inst_t *porta, uint8_t endereco) {
+    uint8_t lixo; // Byte lido apenas para verificar o ACK do endereço
+    return i2c_read_blocking(porta, endereco, &lixo, 1, false) >= 0;
+}
+
+void display_agendar(uint8_t indice) {
+    display_pendente[indice] = display_presente[indice]; // Displays ausentes nunca são enviados
+}
+
+bool display_servico() {
+    bool ativo = false; // Indica se ainda há trabalho a fazer
+
+    // Conclui os envios que terminaram
+    for (uint8_t i = 0; i < NUM_DISPLAYS; i++) {
+        if (ssd1306_busy(displays[i]))
+            ativo = true;
+    }
+
+    // Inicia os envios pendentes cujo barramento está livre, começando por um display diferente a cada envio
+    // para que displays no mesmo barramento se revezem
+    static uint8_t primeiro = 0;
+    uint8_t inicio = primeiro;
+    for (uint8_t k = 0; k < NUM_DISPLAYS; k++) {
+        uint8_t i = (inicio + k) % NUM_DISPLAYS;
+        if (!display_pendente[i])
+            continue;
+
+        // O envio do próprio display também ocupa o barramento: iniciar outro agora bloquearia até o fim dele
+        bool barramento_livre = true;
+        for (uint8_t j = 0; j < NUM_DISPLAYS; j++) {
+            if (displays[j]->in_flight && ssd1306_same_bus(displays[i], displays[j]))
+                barramento_livre = false;
+        }
+
+        if (barramento_livre) {
+            display_pendente[i] = false;
+            primeiro = (i + 1) % NUM_DISPLAYS;    // O próximo display tem a vez na próxima chamada
+            ssd1306_send_data_async(displays[i]); // Sem DMA o envio termina aqui mesmo
+        }
+        ativo = true;
+    }
+
+    return ativo;
+}
+
+void display_flush_todos() {
+    while (display_servico()) // Repete até não haver quadros pendentes nem em envio
+        tight_loop_contents();
+}
+
+void display_relatorio() {
+    static const char *nomes[NUM_DISPLAYS] = { "status", "detalhe" };
+    uint32_t agora = time_us_32();
+    uint32_t quadros = 0;
+
+    for (uint8_t i = 0; i < NUM_DISPLAYS; i++) {
+        ssd1306_t *d = displays[i];
+        if (!display_presente[i]) {
+            printf("OLED %u (%s): ausente\n", i, nomes[i]);
+            continue;
+        }
+        quadros += d->flush_count;
+        printf("OLED %u (%s): ultimo %lu us, medio %lu us, %lu quadros, %lu erros\n",
+               i, nomes[i],
+               (unsigned long)d->flush_last_us,
+               (unsigned long)(d->flush_count ? d->flush_total_us / d->flush_count : 0),
+               (unsigned long)d->flush_count,
+               (unsigned long)d->flush_errors);
+    }
+
+    // Taxa agregada de atualização desde o último relatório
+    uint32_t janela = agora - relatorio_inicio_us;
+    float taxa = janela ? (quadros - relatorio_quadros) * 1e6f / janela : 0.0f;
+    printf("Taxa agregada: %.2f quadros/s em %lu ms\n", taxa, (unsigned long)(janela / 1000));
+    relatorio_inicio_us = agora;
+    relatorio_quadros = quadros;
+}
+
+void executar_benchmark() {
+    static bench_hist_t hist;                                  // Histograma da carga de trabalho atual
+    uint32_t ciclos_por_us = clock_get_hz(clk_sys) / 1000000; // Conversão de ciclos para microssegundos
+
+    printf("Benchmark: %u amostras por carga\n", BENCH_AMOSTRAS);
+    display_flush_todos();                                       // Aguarda os envios em andamento
+    gpio_set_irq_enabled(button_A, GPIO_IRQ_EDGE_FALL, false);  // Ignora os botões durante as medições
+    gpio_set_irq_enabled(button_B, GPIO_IRQ_EDGE_FALL, false); // Ignora os botões durante as medições
+    bench_report_begin();
+
+    // Envio completo do display de status
+    bench_hist_reset(&hist, "oled_full");
+    for (uint16_t i = 0; i < BENCH_AMOSTRAS; i++) {
+        bench_stamp_t inicio = bench_start();
+        ssd1306_send_data(&ssd);
+        bench_stop(&hist, inicio);
+    }
+    bench_hist_print(&hist);
+
+    // Envio parcial do display de status
+    bench_hist_reset(&hist, "oled_partial");
+    for (uint16_t i = 0; i < BENCH_AMOSTRAS; i++) {
+        bench_stamp_t inicio = bench_start();
+        ssd1306_send_columns(&ssd, 0, BENCH_COLUNAS - 1);
+        bench_stop(&hist, inicio);
+    }
+    bench_hist_print(&hist);
+
+    // Desenho de texto no buffer do display
+    bench_hist_reset(&hist, "draw_string");
+    for (uint16_t i = 0; i < BENCH_AMOSTRAS; i++) {
+        bench_stamp_t inicio = bench_start();
+        ssd1306_draw_string(&ssd, "BENCHMARK 0123", 0, 0);
+        bench_stop(&hist, inicio);
+    }
+    bench_hist_print(&hist);
+
+    // Envio de um quadro para a matriz de LEDs
+    bench_hist_reset(&hist, "led_frame");
+    matriz_aguardar_quadro(); // Cada amostra começa com o FIFO vazio
+    for (uint16_t i = 0; i < BENCH_AMOSTRAS; i++) {
+        bench_stamp_t inicio = bench_start();
+        set_led_pattern(selected_r, selected_g, selected_b, i % NUMBERS);
+        bench_stop(&hist, inicio);
+        matriz_aguardar_quadro(); // Fora da medição: o quadro é exibido antes do próximo
+    }
+    bench_hist_print(&hist);
+
+    // Latência de entrada da interrupção de GPIO pelo loopback
+    bench_hist_reset(&hist, "gpio_irq_latency");
+    gpio_set_irq_enabled(BENCH_LOOP_IN, GPIO_IRQ_EDGE_RISE, true);
+    for (uint16_t i = 0; i < BENCH_AMOSTRAS; i++) {
+        bench_irq_recebida = false;
+        uint32_t inicio_us = time_us_32();
+        uint32_t inicio = bench_cycles();
+        sio_hw->gpio_set = 1u << BENCH_LOOP_OUT; // Borda logo após o carimbo, sem chamada de função
+        while (!bench_irq_recebida && time_us_32() - inicio_us < 1000) // Aguarda a interrupção por até 1 ms
+            tight_loop_contents();
+        sio_hw->gpio_clr = 1u << BENCH_LOOP_OUT;
+        if (bench_irq_recebida) {
+            uint32_t ciclos = bench_elapsed(inicio, bench_irq_ciclos);
+            bench_hist_add(&hist, ciclos, ciclos / ciclos_por_us);
+        }
+        sleep_us(50); // Deixa a linha estabilizar em nível baixo
+    }
+    gpio_set_irq_enabled(BENCH_LOOP_IN, GPIO_IRQ_EDGE_RISE, false);
+    if (!hist.samples)
+        printf("# gpio_irq_latency: sem resposta, verifique o jumper entre GPIO%u e GPIO%u\n", BENCH_LOOP_OUT, BENCH_LOOP_IN);
+    bench_hist_print(&hist);
+
+    bench_report_end();
+
+    // Restaura o estado anterior ao benchmark
+    ssd1306_fill(&ssd, false);                         // Limpa o display
+    ssd1306_draw_string(&ssd, "BENCHMARK", 0, 0);     // Desenha uma string
+    ssd1306_draw_string(&ssd, "CONCLUIDO", 0, 20);   // Desenha uma string
+    display_agendar(DISPLAY_STATUS);                // Agenda o envio do display
+    display_flush_todos();                         // Atualiza o display
+    set_led_pattern(selected_r, selected_g, selected_b, displayed_number);
+    gpio_set_irq_enabled(button_A, GPIO_IRQ_EDGE_FALL, true);  // Volta a tratar os botões
+    gpio_set_irq_enabled(button_B, GPIO_IRQ_EDGE_FALL, true); // Volta a tratar os botões
+}
+
+void display_preparar(uint8_t indice) {
+    if (displays[indice]->transport == SSD1306_TRANSPORT_SPI)
+        ssd1306_wait(displays[indice]); // No SPI o DMA lê direto do buffer
+}
+
+bool display_em_dma() {
+    for (uint8_t i = 0; i < NUM_DISPLAYS; i++) {
+        if (displays[i]->in_flight && dma_channel_is_busy(displays[i]->dma_chan))
+            return true;
+    }
+    return false;
+}
+
+void dma_irq_handler() {
+    for (uint8_t i = 0; i < NUM_DISPLAYS; i++) {
+        int canal = displays[i]->dma_chan;
+        if (canal >= 0 && (dma_hw->ints0 & (1u << canal)))
+            dma_hw->ints0 = 1u << canal; // Reconhece a interrupção do canal
+    }
+    eventos |= EVENTO_DMA;
+}
+
+void serial_callback(void *param) {
+    eventos |= EVENTO_SERIAL;
+}
+
+bool tick_callback(repeating_timer_t *t) {
+    eventos |= EVENTO_TICK;
+    return true;
+}
+
+uint32_t aguardar_eventos(bool pode_dormir) {
+    // Com as interrupções desabilitadas nenhum evento se perde entre o teste e o __wfi;
+    // a interrupção pendente acorda o núcleo mesmo assim e é atendida ao reabilitá-las
+    uint32_t estado = save_and_disable_interrupts();
+    if (!eventos && pode_dormir) {
+        util_subsistema_t anterior = util_entrar(UTIL_OCIOSO); // Só o tempo em __wfi conta como ocioso
+        __wfi();
+        util_sair(anterior); // Antes de reabilitar: as interrupções que acordaram o núcleo não são tempo ocioso
+    }
+    restore_interrupts(estado);
+
+    estado = save_and_disable_interrupts();
+    uint32_t pendentes = eventos;
+    eventos = 0;
+    restore_interrupts(estado);
+    return pendentes;
+}
+
+util_subsistema_t util_entrar(util_subsistema_t subsistema) {
+    uint32_t agora = time_us_32();
+    util_subsistema_t anterior = util_atual;
+
+    util_us[util_atual] += agora - util_marca; // Atribui o tempo decorrido ao subsistema que estava ativo
+    util_marca = agora;
+    util_atual = subsistema;
+    return anterior;
+}
+
+void util_sair(util_subsistema_t anterior) {
+    util_entrar(anterior);
+}
+
+void util_fechar_janela() {
+    util_entrar(util_atual); // Atribui ao subsistema atual o tempo até agora
+
+    util_duracao_janela = 0;
+    for (uint8_t i = 0; i < UTIL_TOTAL; i++) {
+        util_janela_us[i] = util_us[i];
+        util_duracao_janela += util_us[i];
+        util_us[i] = 0;
+    }
+}
+
+void util_relatorio() {
+    if (!util_duracao_janela) {
+        printf("UTIL,sem janela fechada\n");
+        return;
+    }
+
+    printf("UTIL,janela_ms=%lu", (unsigned long)(util_duracao_janela / 1000));
+    for (uint8_t i = 0; i < UTIL_TOTAL; i++)
+        printf(",%s=%.2f", util_nomes[i], util_janela_us[i] * 100.0f / util_duracao_janela);
+    printf(",ocupado=%.2f\n", (util_duracao_janela - util_janela_us[UTIL_OCIOSO]) * 100.0f / util_duracao_janela);
+}
+
+void boot_marcar(boot_fase_t fase) {
+    boot_us[fase] = time_us_32(); // O temporizador conta desde o reset
+}
+
+void boot_relatorio() {
+    printf("BOOT");
+    for (uint8_t i = 0; i < BOOT_FASES; i++)
+        printf(",%s=%lu", boot_nomes[i], (unsigned long)boot_us[i]);
+    printf("\n");
+    printf("Inicialização até o primeiro quadro: matriz %lu us, OLED %lu us\n",
+           (unsigned long)boot_us[BOOT_PRIMEIRO_QUADRO], (unsigned long)boot_us[BOOT_OLED_PRONTO]);
+}
+
+static inline uint8_t matriz_indice(uint8_t x, uint8_t y) {
+    uint8_t linha = MATRIZ_LADO - 1 - y; // A cadeia começa na linha de baixo
+    return linha * MATRIZ_LADO + ((linha % 2 == 0) ? MATRIZ_LADO - 1 - x : x); // Linhas pares da direita para a esquerda
+}
+
+void marquee_compilar(const char *texto) {
+    uint16_t n = 0;
+
+    // Espaço inicial para o texto entrar pela direita
+    for (uint8_t i = 0; i < MATRIZ_LADO; i++)
+        marquee_colunas[n++] = 0;
+
+    for (; *texto; texto++) {
+        char c = *texto;
+        uint16_t glifo = 0; // Mesma indexação de ssd1306_draw_char; caracteres sem glifo viram espaço
+        if (c >= '0' && c <= '9')
+            glifo = c - '0' + 1;
+        else if (c >= 'A' && c <= 'Z')
+            glifo = c - 'A' + 11;
+        else if (c >= 'a' && c <= 'z')
+            glifo = c - 'a' + 37;
+        if (glifo >= FONT_MATRIX_GLYPHS)
+            glifo = 0;
+
+        uint8_t largura = font_matrix_width[glifo]; // Cada glifo tem a sua largura
+        if (n + largura + 1 > MARQUEE_MAX_COLUNAS)
+            break;
+        for (uint8_t i = 0; i < largura; i++)
+            marquee_colunas[n++] = font_matrix[glifo * FONT_MATRIX_MAX_WIDTH + i];
+        marquee_colunas[n++] = 0; // Separação entre glifos
+    }
+
+    marquee_total = n;
+    marquee_posicao = 0;
+}
+
+void marquee_iniciar() {
+    marquee_ultimo_us = 0;
+    marquee_jitter_max_us = 0;
+    marquee_passos = 0;
+    marquee_ativo = true;
+    add_repeating_timer_ms(-(int32_t)marquee_periodo_ms, marquee_callback, NULL, &timer_marquee); // Negativo: período entre inícios, sem acumular atraso
+}
+
+void marquee_parar() {
+    if (!marquee_ativo)
+        return;
+    cancel_repeating_timer(&timer_marquee);
+    dma_channel_wait_for_finish_blocking(marquee_dma); // O DMA terminou de escrever no FIFO do PIO
+    matriz_aguardar_quadro();                         // O último quadro é exibido antes do próximo, que segue direto ao PIO
+    marquee_ativo = false;
+}
+
+bool marquee_callback(repeating_timer_t *t) {
+    uint32_t agora = time_us_32();
+
+    // Desvio do período entre dois passos
+    if (marquee_ultimo_us) {
+        int32_t desvio = (int32_t)(agora - marquee_ultimo_us) - (int32_t)(marquee_periodo_ms * 1000);
+        uint32_t absoluto = desvio < 0 ? -desvio : desvio;
+        if (absoluto > marquee_jitter_max_us)
+            marquee_jitter_max_us = absoluto;
+    }
+    marquee_ultimo_us = agora;
+
+    if (dma_channel_is_busy(marquee_dma)) // O quadro anterior ainda está saindo; mantém o ritmo e pula este passo
+        return true;
+
+    // Desloca a janela de uma coluna sobre o fluxo compilado
+    uint32_t cor = urgb_u32(selected_r, selected_g, selected_b) << 8u; // Mesmo alinhamento de put_pixel
+    for (uint8_t x = 0; x < MATRIZ_LADO; x++) {
+        uint8_t coluna = marquee_colunas[(marquee_posicao + x) % marquee_total];
+        for (uint8_t y = 0; y < MATRIZ_LADO; y++)
+            marquee_quadro[matriz_indice(x, y)] = ((coluna >> y) & 1) ? cor : 0;
+    }
+    marquee_posicao = (marquee_posicao + 1) % marquee_total;
+    marquee_passos++;
+
+    dma_channel_transfer_from_buffer_now(marquee_dma, marquee_quadro, NUM_PIXELS);
+    return true;
+}